@@ -0,0 +1,296 @@
+#include "DecayAnalyser.h"
+
+namespace
+{
+    // Octave-band centre frequencies reported to the UI
+    constexpr std::array<float, DecayAnalyser::NUM_BANDS> bandCentres
+        { 125.0f, 250.0f, 500.0f, 1000.0f, 2000.0f, 4000.0f, 8000.0f, 16000.0f };
+
+    constexpr float EDC_FLOOR_DB = -60.0f;
+}
+
+// =============================================================================
+// Result → WebView payload
+// =============================================================================
+juce::var DecayAnalyser::Result::toVar() const
+{
+    juce::Array<juce::var> bands, rt, curve;
+
+    for (int b = 0; b < NUM_BANDS; ++b)
+    {
+        bands.add (bandCentres[(size_t) b]);
+        rt.add (std::round (rt60[(size_t) b] * 100.0f) / 100.0f);
+    }
+
+    // Whole dB is plenty for a 60 dB-tall display and keeps the message small
+    for (auto db : edc)
+        curve.add ((int) std::round (db));
+
+    auto* obj = new juce::DynamicObject();
+    obj->setProperty ("bands",  bands);
+    obj->setProperty ("rt60",   rt);
+    obj->setProperty ("edc",    curve);
+    obj->setProperty ("points", NUM_POINTS);
+    obj->setProperty ("length", lengthSeconds);
+    return juce::var (obj);
+}
+
+// =============================================================================
+// Constructor / Destructor
+// =============================================================================
+DecayAnalyser::DecayAnalyser()
+    : juce::Thread ("NFReverb Decay Analyser")
+{
+    // Periodic Hann window for the analysis frames
+    window.resize ((size_t) FFT_SIZE);
+    for (int i = 0; i < FFT_SIZE; ++i)
+        window[(size_t) i] = 0.5f - 0.5f * std::cos (juce::MathConstants<float>::twoPi
+                                                     * (float) i / (float) FFT_SIZE);
+
+    fftData.resize ((size_t) FFT_SIZE * 2);
+    cache.reserve ((size_t) CACHE_SIZE);
+}
+
+DecayAnalyser::~DecayAnalyser()
+{
+    signalThreadShouldExit();
+    notify();
+    stopThread (2000);
+}
+
+// =============================================================================
+// Message-thread interface
+// =============================================================================
+void DecayAnalyser::requestAnalysis (const SpringTankSettings& settings, double sampleRate)
+{
+    const Request request { settings, sampleRate > 0.0 ? sampleRate : 48000.0 };
+
+    {
+        const juce::ScopedLock sl (lock);
+        if (hasRequest && pending == request)
+            return;
+
+        pending        = request;
+        hasRequest     = true;
+        hasPending     = true;
+        pendingStampMs = juce::Time::getMillisecondCounter();
+    }
+
+    if (! isThreadRunning())
+        startThread (juce::Thread::Priority::low);
+
+    notify();
+}
+
+bool DecayAnalyser::getLatestResult (juce::var& result, int& lastSeen)
+{
+    const juce::ScopedLock sl (lock);
+    if (latestSerial == lastSeen)
+        return false;
+
+    result   = latest;
+    lastSeen = latestSerial;
+    return true;
+}
+
+// =============================================================================
+// Worker thread
+// =============================================================================
+void DecayAnalyser::run()
+{
+    while (! threadShouldExit())
+    {
+        Request request;
+        int waitMs = -1;
+
+        {
+            const juce::ScopedLock sl (lock);
+            if (hasPending)
+            {
+                request = pending;
+                const auto elapsed = (int) (juce::Time::getMillisecondCounter() - pendingStampMs);
+                waitMs = juce::jmax (0, SETTLE_MS - elapsed);
+            }
+        }
+
+        // Nothing requested yet, or parameters still moving — sleep until the
+        // settle window has passed (or a newer request wakes us up)
+        if (waitMs != 0)
+        {
+            wait (waitMs);
+            continue;
+        }
+
+        if (! (hasPublished && request == lastPublished))
+        {
+            auto result = analyse (request);
+
+            const juce::ScopedLock sl (lock);
+            latest        = result->toVar();
+            ++latestSerial;
+            lastPublished = request;
+            hasPublished  = true;
+        }
+
+        // Only go idle if nothing newer arrived while we were analysing
+        const juce::ScopedLock sl (lock);
+        if (pending == request)
+            hasPending = false;
+    }
+}
+
+// =============================================================================
+// Analysis
+// =============================================================================
+std::shared_ptr<const DecayAnalyser::Result> DecayAnalyser::analyse (const Request& request)
+{
+    // ─── Cache lookup (move hit to front) ─────────────────────────────────
+    for (auto it = cache.begin(); it != cache.end(); ++it)
+    {
+        if (it->first == request)
+        {
+            auto hit = *it;
+            cache.erase (it);
+            cache.insert (cache.begin(), hit);
+            return hit.second;
+        }
+    }
+
+    renderImpulse (request, irBuffer);
+
+    const auto sr       = request.sampleRate;
+    const int  numBins  = FFT_SIZE / 2;
+    const int  numFrames = juce::jmax (1, ((int) irBuffer.size() - FFT_SIZE) / HOP_SIZE + 1);
+
+    // ─── Band bin ranges (octave: centre/√2 … centre·√2) ──────────────────
+    std::array<int, NUM_BANDS> binLo {}, binHi {};
+    const float binHz = (float) sr / (float) FFT_SIZE;
+    for (int b = 0; b < NUM_BANDS; ++b)
+    {
+        const float c = bandCentres[(size_t) b];
+        binLo[(size_t) b] = juce::jlimit (1, numBins, (int) std::ceil  (c * 0.7071f / binHz));
+        binHi[(size_t) b] = juce::jlimit (1, numBins, (int) std::floor (c * 1.4142f / binHz));
+    }
+
+    // ─── Per-frame band energy ────────────────────────────────────────────
+    std::vector<float> energy ((size_t) (numFrames * NUM_BANDS), 0.0f);
+
+    for (int f = 0; f < numFrames; ++f)
+    {
+        const int start = f * HOP_SIZE;
+        std::fill (fftData.begin(), fftData.end(), 0.0f);
+
+        const int count = juce::jmin (FFT_SIZE, (int) irBuffer.size() - start);
+        juce::FloatVectorOperations::multiply (fftData.data(), irBuffer.data() + start,
+                                               window.data(), count);
+
+        fft.performFrequencyOnlyForwardTransform (fftData.data(), true);
+
+        for (int b = 0; b < NUM_BANDS; ++b)
+        {
+            float e = 0.0f;
+            for (int k = binLo[(size_t) b]; k <= binHi[(size_t) b]; ++k)
+                e += fftData[(size_t) k] * fftData[(size_t) k];
+            energy[(size_t) (f * NUM_BANDS + b)] = e;
+        }
+    }
+
+    // ─── Schroeder integral → EDC (dB) and RT60 per band ──────────────────
+    auto result = std::make_shared<Result>();
+    result->edc.resize ((size_t) (NUM_BANDS * NUM_POINTS));
+    result->lengthSeconds = (float) (numFrames * HOP_SIZE) / (float) sr;
+
+    std::vector<float> edcDb ((size_t) numFrames);
+    const auto frameTime = [&] (int f) { return (float) (f * HOP_SIZE + FFT_SIZE / 2) / (float) sr; };
+
+    for (int b = 0; b < NUM_BANDS; ++b)
+    {
+        double tail = 0.0;
+        for (int f = numFrames; --f >= 0;)
+        {
+            tail += energy[(size_t) (f * NUM_BANDS + b)];
+            edcDb[(size_t) f] = (float) tail;
+        }
+
+        const float total = juce::jmax (1.0e-20f, edcDb[0]);
+        for (auto& v : edcDb)
+            v = juce::jmax (EDC_FLOOR_DB, 10.0f * std::log10 (juce::jmax (1.0e-20f, v / total)));
+
+        // Least-squares slope over the -5 … -25 dB region (T20, ×3 → RT60)
+        double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+        int n = 0;
+        for (int f = 0; f < numFrames; ++f)
+        {
+            const float db = edcDb[(size_t) f];
+            if (db > -5.0f)  continue;
+            if (db < -25.0f) break;
+
+            const double t = frameTime (f);
+            sx += t; sy += db; sxx += t * t; sxy += t * db;
+            ++n;
+        }
+
+        float rt = 0.0f;
+        if (n >= 2)
+        {
+            const double denom = n * sxx - sx * sx;
+            const double slope = denom != 0.0 ? (n * sxy - sx * sy) / denom : 0.0;   // dB/s
+            if (slope < 0.0)
+                rt = (float) juce::jmin (20.0, -60.0 / slope);
+        }
+        result->rt60[(size_t) b] = rt;
+
+        // Resample the EDC to NUM_POINTS evenly spaced frames
+        for (int p = 0; p < NUM_POINTS; ++p)
+        {
+            const int f = juce::jmin (numFrames - 1, p * numFrames / NUM_POINTS);
+            result->edc[(size_t) (b * NUM_POINTS + p)] = edcDb[(size_t) f];
+        }
+    }
+
+    // ─── Insert into LRU cache ────────────────────────────────────────────
+    if ((int) cache.size() >= CACHE_SIZE)
+        cache.pop_back();
+    cache.insert (cache.begin(), { request, result });
+
+    return result;
+}
+
+// Renders the mono (A+B)/2 wet impulse response into `ir`
+void DecayAnalyser::renderImpulse (const Request& request, std::vector<float>& ir)
+{
+    constexpr int blockSize = 512;
+
+    // Re-prepare only on a sample-rate change; otherwise just clear the tank
+    if (shadowSampleRate != request.sampleRate)
+    {
+        shadowTank.prepare (request.sampleRate, blockSize);
+        shadowSampleRate = request.sampleRate;
+    }
+    else
+    {
+        shadowTank.reset();
+    }
+
+    const auto& s = request.settings;
+    shadowTank.setSettings (s);
+
+    // Pre-delay plus the full decay, so the -25 dB point is always captured
+    const double seconds = juce::jmin (MAX_RENDER_SECONDS,
+                                       s.preDelayMs * 0.001 + (double) s.decay + 0.1);
+    const int numSamples = juce::jmax (FFT_SIZE, (int) (seconds * request.sampleRate));
+    ir.resize ((size_t) numSamples);
+
+    const float driveGain = SpringTank::driveGainFor (s.drive);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float x = (i == 0) ? 1.0f : 0.0f;
+        float wetA, wetB;
+        shadowTank.processSample (x, x, driveGain, wetA, wetB);
+        ir[(size_t) i] = 0.5f * (wetA + wetB);
+
+        if ((i & 0xffff) == 0 && threadShouldExit())
+            break;
+    }
+}
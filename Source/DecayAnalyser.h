@@ -0,0 +1,107 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
+#include "SpringTank.h"
+#include <array>
+#include <memory>
+#include <vector>
+
+// =============================================================================
+// DecayAnalyser — background impulse-response / decay-spectrum analysis
+//
+// Runs a shadow SpringTank on a low-priority worker thread (never the audio
+// thread).  Once the parameters have been stable for SETTLE_MS, it renders an
+// impulse through the shadow tank, slices the response into FFT frames and
+// reports, per octave band:
+//   • the energy-decay curve (Schroeder backward integral, dB)
+//   • the RT60 extrapolated from the -5 … -25 dB part of that curve
+//
+// Results are kept in a small LRU cache keyed by the exact settings, so
+// sweeping a knob back to a previous value costs nothing.  The processor owns
+// the analyser, so the cache (and the last result) outlive the editor; the
+// worker thread is only started by the first request.
+//
+// Threading:
+//   requestAnalysis() / getLatestResult() — message thread (editor timer)
+//   everything else                       — worker thread
+// =============================================================================
+class DecayAnalyser : private juce::Thread
+{
+public:
+    static constexpr int NUM_BANDS  = 8;    // octave bands, 125 Hz … 16 kHz
+    static constexpr int NUM_POINTS = 32;   // EDC points sent per band
+
+    struct Result
+    {
+        std::array<float, NUM_BANDS> rt60 {};           // seconds per band
+        std::vector<float> edc;                         // NUM_BANDS × NUM_POINTS, dB
+        float lengthSeconds { 0.0f };                   // span covered by the EDC points
+
+        // Compact form for the WebView:
+        //   { bands: [Hz…], rt60: [s…], edc: [dB… band-major], points: N, length: s }
+        juce::var toVar() const;
+    };
+
+    DecayAnalyser();
+    ~DecayAnalyser() override;
+
+    // Cheap — call on every editor timer tick.  Only a changed snapshot
+    // restarts the settle countdown.  Starts the worker on first use.
+    void requestAnalysis (const SpringTankSettings& settings, double sampleRate);
+
+    // Returns true when a result newer than `lastSeen` is available and
+    // updates `lastSeen`.  A fresh editor starts from 0, so it picks up the
+    // last result straight away instead of waiting for a new analysis.
+    bool getLatestResult (juce::var& result, int& lastSeen);
+
+private:
+    //==========================================================================
+    struct Request
+    {
+        SpringTankSettings settings;
+        double sampleRate { 0.0 };
+
+        bool operator== (const Request& o) const noexcept
+        {
+            return settings == o.settings && sampleRate == o.sampleRate;
+        }
+    };
+
+    void run() override;
+
+    std::shared_ptr<const Result> analyse (const Request&);
+    void renderImpulse (const Request&, std::vector<float>& ir);
+
+    //==========================================================================
+    static constexpr int    SETTLE_MS  = 250;
+    static constexpr int    CACHE_SIZE = 16;
+    static constexpr int    FFT_ORDER  = 10;    // 1024-point frames
+    static constexpr int    FFT_SIZE   = 1 << FFT_ORDER;
+    static constexpr int    HOP_SIZE   = FFT_SIZE / 2;
+    static constexpr double MAX_RENDER_SECONDS = 10.0;
+
+    // ─── Shared with the message thread (guarded by lock) ─────────────────────
+    juce::CriticalSection lock;
+    Request     pending;
+    bool        hasRequest      { false };   // pending holds a real request
+    bool        hasPending      { false };   // ...that the worker hasn't finished
+    juce::uint32 pendingStampMs { 0 };
+    juce::var   latest;
+    int         latestSerial    { 0 };       // bumped per published result
+
+    // ─── Worker-thread only ───────────────────────────────────────────────────
+    SpringTank shadowTank;
+    double     shadowSampleRate { 0.0 };
+    Request    lastPublished;
+    bool       hasPublished { false };
+
+    std::vector<std::pair<Request, std::shared_ptr<const Result>>> cache;   // MRU first
+
+    juce::dsp::FFT fft { FFT_ORDER };
+    std::vector<float> window;
+    std::vector<float> fftData;
+    std::vector<float> irBuffer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DecayAnalyser)
+};
@@ -0,0 +1,175 @@
+// =============================================================================
+// NFReverbIR — offline impulse-response renderer (command line)
+//
+// Batch-renders the stereo IR of NFReverb parameter sets for preset previews.
+//
+//   NFReverbIR [options] <input>...
+//
+//   input        .json — one preset object, or an array of them, keyed by
+//                        parameter ID: { "name": "Dub Room", "decay": 3.2, … }
+//                .xml  — a saved plugin state (<Parameters><PARAM …/>)
+//
+//   --out=<dir>          output directory                 (default: .)
+//   --format=wav|raw     32-bit float WAV, or raw interleaved float32 (.f32)
+//   --rate=<Hz>          render sample rate               (default: 48000)
+//   --length=<s>         IR length, 0 = auto              (default: 0)
+//   --no-wobble          render without LFO modulation
+//   --wet                wet signal only (ignore mix)
+//   --threads=<n>        worker threads, 0 = one per core (default: 0)
+// =============================================================================
+
+#include <juce_core/juce_core.h>
+#include "ImpulseRenderer.h"
+#include <iostream>
+#include <set>
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "Usage: NFReverbIR [--out=dir] [--format=wav|raw] [--rate=Hz] [--length=s]\n"
+                     "                  [--no-wobble] [--wet] [--threads=n] <preset.json|state.xml>...\n";
+    }
+
+    // Appends every preset found in `file` (JSON object/array or plugin-state XML)
+    juce::Result loadPresets (const juce::File& file, std::vector<ImpulseRenderer::Preset>& presets)
+    {
+        const auto addNamed = [&] (ImpulseRenderer::Preset p, int index)
+        {
+            if (p.name.isEmpty())
+                p.name = file.getFileNameWithoutExtension()
+                       + (index >= 0 ? "_" + juce::String (index + 1) : juce::String());
+            presets.push_back (std::move (p));
+        };
+
+        if (file.hasFileExtension ("xml"))
+        {
+            const auto xml = juce::XmlDocument::parse (file);
+            if (xml == nullptr)
+                return juce::Result::fail ("Cannot parse " + file.getFullPathName());
+
+            addNamed (ImpulseRenderer::Preset::fromStateXml (*xml), -1);
+            return juce::Result::ok();
+        }
+
+        juce::var json;
+        if (auto r = juce::JSON::parse (file.loadFileAsString(), json); r.failed())
+            return juce::Result::fail (file.getFullPathName() + ": " + r.getErrorMessage());
+
+        if (auto* list = json.getArray())
+        {
+            for (int i = 0; i < list->size(); ++i)
+                addNamed (ImpulseRenderer::Preset::fromVar (list->getReference (i)), i);
+        }
+        else
+        {
+            addNamed (ImpulseRenderer::Preset::fromVar (json), -1);
+        }
+
+        return juce::Result::ok();
+    }
+}
+
+// =============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ArgumentList args (argc, argv);
+
+    if (args.size() == 0 || args.containsOption ("--help|-h"))
+    {
+        printUsage();
+        return args.size() == 0 ? 1 : 0;
+    }
+
+    // ─── Options ──────────────────────────────────────────────────────────
+    ImpulseRenderer::Options options;
+    options.skipModulation = args.removeOptionIfFound ("--no-wobble");
+    options.wetOnly        = args.removeOptionIfFound ("--wet");
+
+    if (args.containsOption ("--rate"))
+        options.sampleRate = juce::jlimit (8000.0, 384000.0,
+                                           args.removeValueForOption ("--rate").getDoubleValue());
+    if (args.containsOption ("--length"))
+        options.lengthSeconds = juce::jmax (0.0, args.removeValueForOption ("--length").getDoubleValue());
+
+    const auto format = args.containsOption ("--format")
+                     && args.removeValueForOption ("--format").equalsIgnoreCase ("raw")
+                      ? ImpulseRenderer::FileFormat::rawFloat
+                      : ImpulseRenderer::FileFormat::wav;
+
+    const int numThreads = args.containsOption ("--threads")
+                         ? args.removeValueForOption ("--threads").getIntValue() : 0;
+
+    const auto outDir = args.containsOption ("--out")
+                      ? juce::File::getCurrentWorkingDirectory().getChildFile (args.removeValueForOption ("--out"))
+                      : juce::File::getCurrentWorkingDirectory();
+
+    // ─── Inputs → presets ─────────────────────────────────────────────────
+    std::vector<ImpulseRenderer::Preset> presets;
+
+    for (const auto& arg : args.arguments)
+    {
+        if (arg.isOption())
+        {
+            std::cerr << "Unknown option: " << arg.text << "\n";
+            printUsage();
+            return 1;
+        }
+
+        const auto file = arg.resolveAsFile();
+        if (! file.existsAsFile())
+        {
+            std::cerr << "No such file: " << file.getFullPathName() << "\n";
+            return 1;
+        }
+
+        if (auto r = loadPresets (file, presets); r.failed())
+        {
+            std::cerr << r.getErrorMessage() << "\n";
+            return 1;
+        }
+    }
+
+    // ─── Render ───────────────────────────────────────────────────────────
+    const auto extension = format == ImpulseRenderer::FileFormat::wav ? ".wav" : ".f32";
+
+    // Names can repeat (two presets called the same, or unnamed presets from
+    // same-stem files in different folders), so later ones get _2, _3, …
+    // Compared case-insensitively, as the output folder may be.
+    std::vector<ImpulseRenderer::Job> jobs;
+    std::set<juce::String> usedNames;
+
+    for (auto& p : presets)
+    {
+        const auto base = juce::File::createLegalFileName (p.name);
+        auto fileName   = base + extension;
+
+        for (int n = 2; ! usedNames.insert (fileName.toLowerCase()).second; ++n)
+            fileName = base + "_" + juce::String (n) + extension;
+
+        jobs.push_back ({ std::move (p), outDir.getChildFile (fileName) });
+    }
+
+    const auto start   = juce::Time::getMillisecondCounterHiRes();
+    const auto results = ImpulseRenderer::renderBatch (jobs, options, format, numThreads);
+
+    int failures = 0;
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        if (results[i].failed())
+        {
+            std::cerr << "FAILED " << jobs[i].output.getFullPathName() << ": "
+                      << results[i].getErrorMessage() << "\n";
+            ++failures;
+        }
+        else
+        {
+            std::cout << jobs[i].output.getFullPathName() << "\n";
+        }
+    }
+
+    std::cout << (int) jobs.size() - failures << "/" << (int) jobs.size() << " IRs rendered in "
+              << juce::String ((juce::Time::getMillisecondCounterHiRes() - start) / 1000.0, 2) << " s\n";
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,204 @@
+#include "ImpulseRenderer.h"
+#include <atomic>
+
+// =============================================================================
+// Presets
+// =============================================================================
+ImpulseRenderer::Preset ImpulseRenderer::Preset::fromVar (const juce::var& v)
+{
+    Preset p;
+    auto& s = p.settings;
+
+    // Missing keys keep the defaults; everything is clamped to the same
+    // ranges as the plugin's parameters (ParameterRanges.hpp)
+    const auto get = [&v] (const char* id, float current, const ParameterRanges::Float& spec)
+    {
+        const auto& value = v[id];
+        return spec.clamp (value.isVoid() ? current : (float) value);
+    };
+
+    p.name       = v["name"].toString();
+    p.mix        = get ("mix",       p.mix,        ParameterRanges::mix);
+    s.decay      = get ("decay",     s.decay,      ParameterRanges::decay);
+    s.tension    = get ("tension",   s.tension,    ParameterRanges::tension);
+    s.preDelayMs = get ("pre_delay", s.preDelayMs, ParameterRanges::pre_delay);
+    s.damping    = get ("damping",   s.damping,    ParameterRanges::damping);
+    s.wobble     = get ("wobble",    s.wobble,     ParameterRanges::wobble);
+    s.drive      = get ("drive",     s.drive,      ParameterRanges::drive);
+
+    // Kernel by name ("Hermite") or by choice index (as stored in plugin state)
+    const auto& interp  = v["interp"];
+    const auto  names   = FractionalDelay::getKernelNames();
+    const int   index   = interp.isString() ? names.indexOf (interp.toString(), true)
+                                            : (interp.isVoid() ? ParameterRanges::interpDefault : (int) interp);
+    s.interp = (FractionalDelay::Kernel) juce::jlimit (0, names.size() - 1, index);
+
+    return p;
+}
+
+ImpulseRenderer::Preset ImpulseRenderer::Preset::fromStateXml (const juce::XmlElement& xml)
+{
+    auto* obj = new juce::DynamicObject();
+
+    for (auto* param : xml.getChildWithTagNameIterator ("PARAM"))
+        obj->setProperty (param->getStringAttribute ("id"),
+                          param->getDoubleAttribute ("value"));
+
+    return fromVar (juce::var (obj));
+}
+
+// =============================================================================
+// Render
+// =============================================================================
+void ImpulseRenderer::render (const Preset& preset, const Options& options,
+                              juce::AudioBuffer<float>& out)
+{
+    const double sampleRate = options.getSampleRate();
+
+    // Prepare once per sample rate; afterwards a reset is all a render needs
+    if (preparedSampleRate != sampleRate)
+    {
+        tank.prepare (sampleRate, 512);
+        preparedSampleRate = sampleRate;
+    }
+    else
+    {
+        tank.reset();
+    }
+
+    auto settings = preset.settings;
+    if (options.skipModulation)
+        settings.wobble = 0.0f;
+
+    tank.setSettings (settings);
+
+    const double seconds = options.lengthSeconds > 0.0
+                         ? options.lengthSeconds
+                         : settings.preDelayMs * 0.001 + 2.0 * (double) settings.decay + 0.1;
+    const int numSamples = juce::jmax (1, (int) (juce::jmin (MAX_LENGTH_SECONDS, seconds)
+                                                 * sampleRate));
+
+    out.setSize (2, numSamples, false, false, true);
+
+    const float driveGain = SpringTank::driveGainFor (settings.drive);
+    const float wetGain   = (options.wetOnly ? 1.0f : preset.mix) / IMPULSE_LEVEL;
+
+    auto* left  = out.getWritePointer (0);
+    auto* right = out.getWritePointer (1);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float x = (i == 0) ? IMPULSE_LEVEL : 0.0f;
+        float wetA, wetB;
+        tank.processSample (x, x, driveGain, wetA, wetB);
+        left[i]  = wetA * wetGain;
+        right[i] = wetB * wetGain;
+    }
+
+    // Dry path is a plain (1 − mix)·δ
+    if (! options.wetOnly)
+    {
+        left[0]  += 1.0f - preset.mix;
+        right[0] += 1.0f - preset.mix;
+    }
+}
+
+// =============================================================================
+// File output
+// =============================================================================
+juce::Result ImpulseRenderer::writeFile (const juce::AudioBuffer<float>& buffer, double sampleRate,
+                                         FileFormat format, const juce::File& file)
+{
+    if (auto r = file.getParentDirectory().createDirectory(); r.failed())
+        return r;
+
+    file.deleteFile();
+
+    auto stream = std::make_unique<juce::FileOutputStream> (file);
+    if (! stream->openedOk())
+        return juce::Result::fail ("Cannot open " + file.getFullPathName());
+
+    if (format == FileFormat::rawFloat)
+    {
+        // Interleaved little-endian float32, no header
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                if (! stream->writeFloat (buffer.getSample (ch, i)))
+                    return juce::Result::fail ("Write failed: " + file.getFullPathName());
+
+        return juce::Result::ok();
+    }
+
+    // 32-bit WAV is written as IEEE float, so the tail keeps full resolution
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer (
+        wav.createWriterFor (stream.get(), sampleRate,
+                             (unsigned int) buffer.getNumChannels(), 32, {}, 0));
+
+    if (writer == nullptr)
+        return juce::Result::fail ("Cannot create WAV writer for " + file.getFullPathName());
+
+    stream.release();   // now owned by the writer
+
+    if (! writer->writeFromAudioSampleBuffer (buffer, 0, buffer.getNumSamples()))
+        return juce::Result::fail ("Write failed: " + file.getFullPathName());
+
+    return juce::Result::ok();
+}
+
+// =============================================================================
+// Batch
+// =============================================================================
+std::vector<juce::Result> ImpulseRenderer::renderBatch (const std::vector<Job>& jobs,
+                                                        const Options& options,
+                                                        FileFormat format, int numThreads)
+{
+    std::vector<juce::Result> results (jobs.size(), juce::Result::ok());
+    if (jobs.empty())
+        return results;
+
+    // Two workers writing one path would race and both report success, so a
+    // repeated output fails up front and only its first job is rendered
+    for (size_t i = 1; i < jobs.size(); ++i)
+        for (size_t j = 0; j < i; ++j)
+            if (jobs[i].output == jobs[j].output)
+            {
+                results[i] = juce::Result::fail ("Duplicate output path: " + jobs[i].output.getFullPathName());
+                break;
+            }
+
+    if (numThreads <= 0)
+        numThreads = juce::SystemStats::getNumCpus();
+    numThreads = juce::jlimit (1, (int) jobs.size(), numThreads);
+
+    std::atomic<size_t> nextJob { 0 };
+    std::atomic<int>    running { numThreads };
+    juce::WaitableEvent allDone;
+
+    juce::ThreadPool pool (numThreads);
+
+    for (int t = 0; t < numThreads; ++t)
+    {
+        pool.addJob ([&]
+        {
+            // One prepared tank + IR buffer per worker, reused for every job it picks up
+            ImpulseRenderer renderer;
+            juce::AudioBuffer<float> ir;
+
+            for (size_t i; (i = nextJob++) < jobs.size();)
+            {
+                if (results[i].failed())
+                    continue;
+
+                renderer.render (jobs[i].preset, options, ir);
+                results[i] = writeFile (ir, options.getSampleRate(), format, jobs[i].output);
+            }
+
+            if (--running == 0)
+                allDone.signal();
+        });
+    }
+
+    allDone.wait();
+    return results;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_dsp/juce_dsp.h>
+#include "SpringTank.h"
+#include <vector>
+
+// =============================================================================
+// ImpulseRenderer — offline stereo impulse responses for preset previews
+//
+// Renders what the processor would output for a unit impulse on both inputs:
+//   out = (1 − mix)·δ + mix·wet        (or wet only, see Options::wetOnly)
+// String A only ever sees the left input and String B the right, so a
+// 2-channel IR (L→L, R→R) is the complete response — no cross terms.
+//
+// Audition files can then be made by (partitioned) convolution, e.g.
+// juce::dsp::Convolution, instead of running the tank over every file.
+// Two things convolution cannot reproduce, so the render pins them down:
+//   • drive   — the impulse is fed at IMPULSE_LEVEL and rescaled, i.e. the
+//               small-signal (linear) response of the tanh stage
+//   • wobble  — time-varying; Options::skipModulation renders it at depth 0
+//
+// Nothing here touches the real-time processor: every render runs on its
+// own SpringTank, prepared once and reset between renders.
+// =============================================================================
+class ImpulseRenderer
+{
+public:
+    static constexpr double DEFAULT_SAMPLE_RATE = 48000.0;
+
+    struct Options
+    {
+        double sampleRate     { 0.0 };     // 0 = DEFAULT_SAMPLE_RATE (processor: its own rate)
+        double lengthSeconds  { 0.0 };     // 0 = auto (pre-delay + 2 × decay)
+        bool   skipModulation { false };   // render with wobble = 0
+        bool   wetOnly        { false };   // omit the dry impulse / mix blend
+
+        double getSampleRate() const noexcept { return sampleRate > 0.0 ? sampleRate : DEFAULT_SAMPLE_RATE; }
+    };
+
+    // One parameter set: everything that shapes the IR
+    struct Preset
+    {
+        juce::String       name;
+        SpringTankSettings settings;
+        float              mix { ParameterRanges::mix.defaultValue };
+
+        // From a JSON-style object { "name": …, "decay": 2.0, "interp": "Hermite", … }.
+        // Keys are the parameter IDs; missing keys keep the parameter defaults.
+        static Preset fromVar (const juce::var&);
+
+        // From the plugin's saved state (the APVTS XML: <Parameters><PARAM id value/>…)
+        static Preset fromStateXml (const juce::XmlElement&);
+    };
+
+    enum class FileFormat { wav, rawFloat };
+
+    //==========================================================================
+    ImpulseRenderer() = default;
+
+    // Renders into `out` (resized as needed — reuse it across calls)
+    void render (const Preset&, const Options&, juce::AudioBuffer<float>& out);
+
+    //==========================================================================
+    // 32-bit float WAV, or raw interleaved little-endian float32
+    static juce::Result writeFile (const juce::AudioBuffer<float>&, double sampleRate,
+                                   FileFormat, const juce::File&);
+
+    struct Job
+    {
+        Preset     preset;
+        juce::File output;
+    };
+
+    // Renders and writes every job on numThreads workers (≤ 0 = one per core).
+    // Each worker owns one renderer, so tanks are prepared once per worker,
+    // not once per job.  Returns one Result per job, in order; a job whose
+    // output path repeats an earlier job's fails without being rendered.
+    static std::vector<juce::Result> renderBatch (const std::vector<Job>&, const Options&,
+                                                  FileFormat, int numThreads = 0);
+
+private:
+    static constexpr float  IMPULSE_LEVEL      = 1.0e-3f;   // -60 dBFS: tanh ≈ linear
+    static constexpr double MAX_LENGTH_SECONDS = 20.0;
+
+    SpringTank tank;
+    double     preparedSampleRate { 0.0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ImpulseRenderer)
+};
@@ -0,0 +1,130 @@
+// =============================================================================
+// NFReverbKernelBench — cost of the AP3 fractional-delay kernels
+//
+// Reproduces the table in SpringTank.h (FractionalDelay):
+//   • one processPair<K> call (both strings' AP3), per kernel
+//   • one whole SpringTank::processSample, per kernel
+// Each figure is the best of RUNS timed runs of NUM_SAMPLES calls, in ns/call.
+// Build in Release; the numbers are only comparable on the same machine.
+//
+//   NFReverbKernelBench [--rate=<Hz>]     (default: 48000)
+// =============================================================================
+
+#include <juce_core/juce_core.h>
+#include "SpringTank.h"
+#include <iostream>
+#include <limits>
+
+namespace
+{
+    constexpr int RUNS        = 7;
+    constexpr int NUM_SAMPLES = 1 << 20;
+
+    // Best-of-RUNS time of `body`, in ns per sample
+    template <typename Body>
+    double timeBest (Body&& body)
+    {
+        double best = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < RUNS; ++run)
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+            body();
+            const auto ticks = juce::Time::getHighResolutionTicks() - start;
+
+            best = juce::jmin (best, juce::Time::highResolutionTicksToSeconds (ticks));
+        }
+
+        return best * 1.0e9 / NUM_SAMPLES;
+    }
+
+    // processPair<K> alone, with both delays swept the way the LFO does
+    template <typename K>
+    double benchPair (double sampleRate, float& sink)
+    {
+        AllpassSection a, b;
+        const int maxDelay = (int) (0.02 * sampleRate);
+        a.prepare (maxDelay);
+        b.prepare (maxDelay);
+
+        // Swept delays are precomputed so only the kernel is inside the timing
+        const float centre = 0.5f * (float) maxDelay;
+        const float depth  = 0.1f * centre;
+        std::vector<float> mod ((size_t) NUM_SAMPLES);
+        for (size_t i = 0; i < mod.size(); ++i)
+            mod[i] = depth * std::sin (juce::MathConstants<float>::twoPi * 0.8f
+                                       * (float) i / (float) sampleRate);
+
+        return timeBest ([&]
+        {
+            for (int i = 0; i < NUM_SAMPLES; ++i)
+            {
+                float xA = (i & 255) == 0 ? 1.0f : 0.0f;
+                float xB = xA;
+                const float m = mod[(size_t) i];
+
+                FractionalDelay::processPair<K> (a, b, xA, xB, centre + m, centre - m, 0.6f);
+                sink += xA + xB;
+            }
+        });
+    }
+
+    // A whole tank sample with the given AP3 kernel
+    double benchTank (double sampleRate, FractionalDelay::Kernel kernel, float& sink)
+    {
+        SpringTank tank;
+        tank.prepare (sampleRate, 512);
+
+        SpringTankSettings settings;
+        settings.interp = kernel;
+        tank.setSettings (settings);
+
+        const float driveGain = SpringTank::driveGainFor (settings.drive);
+
+        return timeBest ([&]
+        {
+            for (int i = 0; i < NUM_SAMPLES; ++i)
+            {
+                const float x = (i & 255) == 0 ? 1.0f : 0.0f;
+                float wetA, wetB;
+                tank.processSample (x, x, driveGain, wetA, wetB);
+                sink += wetA + wetB;
+            }
+        });
+    }
+}
+
+// =============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ArgumentList args (argc, argv);
+
+    const double sampleRate = args.containsOption ("--rate")
+                            ? juce::jlimit (8000.0, 384000.0,
+                                            args.removeValueForOption ("--rate").getDoubleValue())
+                            : 48000.0;
+
+    using namespace FractionalDelay;
+    float sink = 0.0f;   // keeps the optimiser from discarding the work
+
+    const double pair[] { benchPair<Linear>   (sampleRate, sink),
+                          benchPair<Lagrange> (sampleRate, sink),
+                          benchPair<Hermite>  (sampleRate, sink),
+                          benchPair<Allpass>  (sampleRate, sink) };
+
+    const auto names = getKernelNames();
+
+    std::cout << "processPair, both strings (ns/call, best of " << RUNS << ")\n";
+    for (int k = 0; k < names.size(); ++k)
+        std::cout << "  " << names[k].paddedRight (' ', 10)
+                  << juce::String (pair[k], 1).paddedLeft (' ', 7) << " ns   "
+                  << juce::String (pair[k] / pair[0], 1) << "x\n";
+
+    std::cout << "SpringTank::processSample (ns/sample, best of " << RUNS << ")\n";
+    for (int k = 0; k < names.size(); ++k)
+        std::cout << "  " << names[k].paddedRight (' ', 10)
+                  << juce::String (benchTank (sampleRate, (Kernel) k, sink), 1).paddedLeft (' ', 7)
+                  << " ns\n";
+
+    return std::isfinite (sink) ? 0 : 1;
+}
@@ -12,6 +12,11 @@ namespace ParameterIDs
     PARAMETER_ID (damping)
     PARAMETER_ID (wobble)
     PARAMETER_ID (drive)
+    PARAMETER_ID (interp)
+    PARAMETER_ID (duck_threshold)
+    PARAMETER_ID (duck_depth)
+    PARAMETER_ID (duck_attack)
+    PARAMETER_ID (duck_release)
 
 #undef PARAMETER_ID
 }
@@ -0,0 +1,41 @@
+#pragma once
+#include <juce_core/juce_core.h>
+
+// =============================================================================
+// ParameterRanges — range and default of every parameter, in one place
+//
+// Read by createParameterLayout(), the SpringTankSettings / ducker defaults and
+// ImpulseRenderer::Preset::fromVar(), so the plugin and NFReverbIR can't drift.
+// Only needs juce_core (NFReverbIR does not link juce_audio_processors).
+// IDs live in ParameterIDs.hpp.
+// =============================================================================
+namespace ParameterRanges
+{
+    struct Float
+    {
+        float start, end;
+        float interval     { 0.0f };
+        float skew         { 1.0f };
+        float defaultValue { 0.0f };
+
+        juce::NormalisableRange<float> range() const { return { start, end, interval, skew }; }
+        float clamp (float v) const noexcept         { return juce::jlimit (start, end, v); }
+    };
+
+    inline constexpr Float mix       { 0.0f,   1.0f, 0.0f,  1.0f,  0.5f };
+    inline constexpr Float decay     { 0.1f,   8.0f, 0.01f, 0.4f,  2.0f };   // s, skewed for fine control at short values
+    inline constexpr Float tension   { 0.0f,   1.0f, 0.0f,  1.0f,  0.5f };
+    inline constexpr Float pre_delay { 0.0f, 100.0f, 0.1f,  1.0f, 10.0f };   // ms
+    inline constexpr Float damping   { 0.0f,   1.0f, 0.0f,  1.0f,  0.4f };
+    inline constexpr Float wobble    { 0.0f,   1.0f, 0.0f,  1.0f,  0.3f };
+    inline constexpr Float drive     { 0.0f,   1.0f, 0.0f,  1.0f,  0.2f };
+
+    // AP3 fractional-delay kernel: choice index (= FractionalDelay::Kernel)
+    inline constexpr int interpDefault = 0;
+
+    // ─── Sidechain ducking ────────────────────────────────────────────────────
+    inline constexpr Float duck_threshold { -60.0f,    0.0f, 0.1f, 1.0f, -24.0f };   // dB
+    inline constexpr Float duck_depth     {   0.0f,    1.0f, 0.0f, 1.0f,   0.0f };   // 0 = ducking off
+    inline constexpr Float duck_attack    {   0.1f,  100.0f, 0.1f, 0.4f,   5.0f };   // ms
+    inline constexpr Float duck_release   {  10.0f, 1000.0f, 1.0f, 0.4f, 150.0f };   // ms
+}
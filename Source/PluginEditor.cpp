@@ -63,9 +63,17 @@ NFReverbAudioProcessorEditor::NFReverbAudioProcessorEditor (NFReverbAudioProcess
     // Window size matches approved design (620 × 220 px)
     setSize (620, 220);
 
+    // Poll parameters for the decay display (analyser debounces internally)
+    startTimerHz (15);
+
     DBG ("NFReverb: Editor constructor completed");
 }
 
+NFReverbAudioProcessorEditor::~NFReverbAudioProcessorEditor()
+{
+    stopTimer();
+}
+
 // =============================================================================
 // Paint / Resized
 // =============================================================================
@@ -80,6 +88,19 @@ void NFReverbAudioProcessorEditor::resized()
         webView->setBounds (getLocalBounds());
 }
 
+// =============================================================================
+// Decay display
+// =============================================================================
+void NFReverbAudioProcessorEditor::timerCallback()
+{
+    auto& analyser = audioProcessor.getDecayAnalyser();
+    analyser.requestAnalysis (audioProcessor.getTankSettings(), audioProcessor.getSampleRate());
+
+    juce::var result;
+    if (webView != nullptr && analyser.getLatestResult (result, lastDecayResult))
+        webView->emitEventIfBrowserIsVisible ("decayAnalysis", result);
+}
+
 // =============================================================================
 // Resource Provider
 //
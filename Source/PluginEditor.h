@@ -16,13 +16,18 @@
 //   2. webView declared SECOND → destroyed MIDDLE (relays still alive)
 //   3. Attachments declared LAST → destroyed FIRST (safe to release first)
 //
+// The decay display is rendered by the processor's DecayAnalyser; the editor
+// only polls it on a timer and pushes results to the page as the
+// "decayAnalysis" event.
+//
 // See: .claude/troubleshooting/resolutions/webview-member-order-crash.md
 // =============================================================================
-class NFReverbAudioProcessorEditor : public juce::AudioProcessorEditor
+class NFReverbAudioProcessorEditor : public juce::AudioProcessorEditor,
+                                     private juce::Timer
 {
 public:
     explicit NFReverbAudioProcessorEditor (NFReverbAudioProcessor&);
-    ~NFReverbAudioProcessorEditor() override = default;
+    ~NFReverbAudioProcessorEditor() override;
 
     void paint (juce::Graphics&) override;
     void resized() override;
@@ -58,6 +63,13 @@ private:
     std::unique_ptr<juce::WebSliderParameterAttachment> wobbleAttachment;
     std::unique_ptr<juce::WebSliderParameterAttachment> driveAttachment;
 
+    // =========================================================================
+    // Decay display (polls the processor's analyser)
+    // =========================================================================
+    int lastDecayResult { 0 };   // DecayAnalyser result serial already sent
+
+    void timerCallback() override;
+
     // =========================================================================
     // Resource provider
     // =========================================================================
@@ -2,114 +2,20 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
-#include <array>
-#include <cmath>
-#include <vector>
-
-// =============================================================================
-// Schroeder delay-based allpass section
-//
-// Transfer function: H(z) = (g + z^-N) / (1 + g*z^-N)
-// State equation:    v[n] = x[n] - g*v[n-N]
-//                    y[n] = g*v[n] + v[n-N]
-//
-// Used in the spring tank to provide dense, diffuse reflections.
-// =============================================================================
-struct AllpassSection
-{
-    std::vector<float> buf;
-    int writePos { 0 };
-    int maxSize  { 0 };
-
-    void prepare (int maxDelaySamples)
-    {
-        maxSize = maxDelaySamples + 4;   // headroom for interpolation
-        buf.assign ((size_t) maxSize, 0.0f);
-        writePos = 0;
-    }
-
-    // Fixed integer delay allpass
-    float process (float input, int delaySamples, float g) noexcept
-    {
-        delaySamples = juce::jlimit (1, maxSize - 2, delaySamples);
-        const int readPos = (writePos - delaySamples + maxSize) % maxSize;
-        const float vDelayed = buf[(size_t) readPos];
-        const float v = input - g * vDelayed;
-        buf[(size_t) writePos] = v;
-        writePos = (writePos + 1) % maxSize;
-        return g * v + vDelayed;
-    }
-
-    // Linear-interpolated allpass (for LFO modulation — avoids clicks)
-    float processInterp (float input, float delaySamples, float g) noexcept
-    {
-        delaySamples = juce::jlimit (1.0f, (float)(maxSize - 3), delaySamples);
-        const int   intD = (int) delaySamples;
-        const float frac = delaySamples - (float) intD;
-
-        const int r0 = (writePos - intD     + maxSize) % maxSize;
-        const int r1 = (writePos - intD - 1 + maxSize) % maxSize;
-        const float vDelayed = buf[(size_t) r0] * (1.0f - frac)
-                             + buf[(size_t) r1] * frac;
-
-        const float v = input - g * vDelayed;
-        buf[(size_t) writePos] = v;
-        writePos = (writePos + 1) % maxSize;
-        return g * v + vDelayed;
-    }
-
-    void reset() noexcept
-    {
-        std::fill (buf.begin(), buf.end(), 0.0f);
-        writePos = 0;
-    }
-};
-
-// =============================================================================
-// Simple mono circular pre-delay buffer
-// =============================================================================
-struct PreDelayBuffer
-{
-    std::vector<float> buf;
-    int writePos { 0 };
-    int maxSize  { 0 };
-
-    void prepare (int maxDelaySamples)
-    {
-        maxSize = maxDelaySamples + 2;
-        buf.assign ((size_t) maxSize, 0.0f);
-        writePos = 0;
-    }
-
-    void write (float sample) noexcept
-    {
-        buf[(size_t) writePos] = sample;
-        writePos = (writePos + 1) % maxSize;
-    }
-
-    float read (int delaySamples) const noexcept
-    {
-        delaySamples = juce::jlimit (0, maxSize - 1, delaySamples);
-        const int readPos = (writePos - 1 - delaySamples + maxSize) % maxSize;
-        return buf[(size_t) readPos];
-    }
-
-    void reset() noexcept
-    {
-        std::fill (buf.begin(), buf.end(), 0.0f);
-        writePos = 0;
-    }
-};
+#include "SpringTank.h"
+#include "SidechainDucker.h"
+#include "ImpulseRenderer.h"
+#include "DecayAnalyser.h"
 
 // =============================================================================
 // NFReverbAudioProcessor (NeonFameReverberation) — Deep House Spring Reverb
 //
 // Signal chain (per channel):
-//   Input → PreDelay → Drive (tanh) → Spring Tank → Mix Blend → Output
+//   Input → PreDelay → Drive (tanh) → Spring Tank → Duck → Mix Blend → Output
+//                                                     ↑
+//                                        Sidechain bus (optional)
 //
-// Spring Tank (2 parallel strings, String A = left, String B = right):
-//   Input + Feedback → AP1 → AP2 → AP3[LFO] → Output
-//                                            → LP(damping) → × fbGain → Feedback
+// Everything up to the ducker lives in SpringTank (see SpringTank.h).
 // =============================================================================
 class NFReverbAudioProcessor : public juce::AudioProcessor
 {
@@ -146,50 +52,45 @@ public:
     void setStateInformation (const void* data, int sizeInBytes) override;
 
     //==========================================================================
-    juce::AudioProcessorValueTreeState apvts;
-
-private:
-    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+    // Snapshot of the current wet-path parameters (safe from any thread)
+    SpringTankSettings getTankSettings() const noexcept;
 
-    //==========================================================================
-    // Runtime state
-    double currentSampleRate { 44100.0 };
+    // Current settings (incl. mix) as a preset for ImpulseRenderer
+    ImpulseRenderer::Preset getCurrentPreset() const;
 
-    // ─── Pre-delay (one buffer per channel, max 100 ms) ───────────────────────
-    std::array<PreDelayBuffer, 2> preDelay;
+    // Offline stereo IR of the current settings for preset previews, at the
+    // processor's sample rate unless options.sampleRate says otherwise.
+    // Renders on its own (reused) tank, so it is safe alongside processBlock —
+    // but call it from the message or a worker thread, never the audio thread.
+    juce::AudioBuffer<float> renderImpulseResponse (ImpulseRenderer::Options = {}) const;
 
-    // ─── Spring tank: String A (left) ─────────────────────────────────────────
-    std::array<AllpassSection, 3> apA;
-    juce::dsp::FirstOrderTPTFilter<float> dampA;   // LP filter in feedback path
-    float feedbackA { 0.0f };
+    // Background decay analysis for the editor's display.  Lives here rather
+    // than in the editor so its result cache survives the editor closing.
+    DecayAnalyser& getDecayAnalyser() noexcept { return decayAnalyser; }
 
-    // ─── Spring tank: String B (right, +2 ms offset for decorrelation) ────────
-    std::array<AllpassSection, 3> apB;
-    juce::dsp::FirstOrderTPTFilter<float> dampB;
-    float feedbackB { 0.0f };
+    //==========================================================================
+    juce::AudioProcessorValueTreeState apvts;
 
-    // ─── LFO (one per string, rates slightly detuned) ─────────────────────────
-    float lfoPhaseA  { 0.0f };
-    float lfoPhaseB  { 0.0f };
-    static constexpr float LFO_RATE_A = 0.50f;   // Hz
-    static constexpr float LFO_RATE_B = 0.71f;   // Hz
+private:
+    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
-    // ─── Allpass delay lengths (samples, computed in prepareToPlay) ───────────
-    // String A: ~5 ms, ~9 ms, ~14 ms
-    // String B: ~7 ms, ~11 ms, ~16 ms  (+2 ms offset)
-    int apDelayA[3] { 220, 397, 617 };
-    int apDelayB[3] { 308, 485, 705 };
+    //==========================================================================
+    // Wet signal path: pre-delay, drive and both spring strings
+    SpringTank tank;
 
-    // Max LFO wobble depth in samples (= 3 ms at current sample rate)
-    float maxWobbleSamples { 132.0f };
+    // Wet-signal ducking keyed from the sidechain bus
+    SidechainDucker ducker;
 
     // ─── Parameter smoothers (10 ms ramp, prevents zipper noise) ─────────────
     juce::LinearSmoothedValue<float> smoothMix;
     juce::LinearSmoothedValue<float> smoothDrive;
 
-    // ─── Helpers ──────────────────────────────────────────────────────────────
-    static float applyDrive (float x, float driveGain) noexcept;
-    void resetSpringTank() noexcept;
+    // Decay display analysis (own thread, started by the first editor request)
+    DecayAnalyser decayAnalyser;
+
+    // Offline IR renders: one renderer kept prepared between calls
+    mutable juce::CriticalSection irRenderLock;
+    mutable ImpulseRenderer       irRenderer;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (NFReverbAudioProcessor)
 };
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "ParameterRanges.hpp"
+#include <vector>
+
+// =============================================================================
+// SidechainDucker — wet-signal ducking keyed from the sidechain bus
+//
+// Works a block at a time and hands back one gain per sample for the wet path:
+//   |sidechain| (max over channels) → peak envelope (attack/release)
+//     → duck amount = clamp((env − thr) / (thr · (KNEE − 1)), 0, 1)
+//     → gain        = 1 − depth · amount
+//
+// Only the envelope recursion is a scalar loop; rectify, gain computer and
+// depth scaling are FloatVectorOperations over the whole block.  The gain
+// computer stays in the linear domain so no per-sample log/exp is needed:
+// ducking starts at the threshold and is fully applied KNEE× (+12 dB) above it.
+// =============================================================================
+struct SidechainDucker
+{
+    struct Settings
+    {
+        float thresholdDb { ParameterRanges::duck_threshold.defaultValue };
+        float depth       { ParameterRanges::duck_depth.defaultValue };   // 0 = off, 1 = wet fully muted at peak
+        float attackMs    { ParameterRanges::duck_attack.defaultValue };
+        float releaseMs   { ParameterRanges::duck_release.defaultValue };
+    };
+
+    void prepare (double sampleRate, int maximumBlockSize)
+    {
+        currentSampleRate = sampleRate;
+        gains.assign ((size_t) juce::jmax (1, maximumBlockSize), 1.0f);
+        smoothDepth.reset (sampleRate, 0.010);   // 10 ms ramp, matches the other smoothers
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        envelope = 0.0f;
+        smoothDepth.setCurrentAndTargetValue (smoothDepth.getTargetValue());
+    }
+
+    int getMaxBlockSize() const noexcept { return (int) gains.size(); }
+
+    //==========================================================================
+    // Fills and returns numSamples (≤ getMaxBlockSize()) wet gains, reading the
+    // sidechain from startSample.  Pass numScChannels = 0 when the bus is off.
+    const float* process (const float* const* sidechain, int numScChannels,
+                          int startSample, int numSamples, const Settings& s) noexcept
+    {
+        jassert (numSamples <= getMaxBlockSize());
+        float* g = gains.data();
+
+        smoothDepth.setTargetValue (numScChannels > 0 ? s.depth : 0.0f);
+
+        // Nothing to do: bus off (or depth at zero) and no ramp in progress
+        if (! smoothDepth.isSmoothing() && smoothDepth.getTargetValue() <= 0.0f)
+        {
+            envelope = 0.0f;
+            juce::FloatVectorOperations::fill (g, 1.0f, numSamples);
+            return g;
+        }
+
+        // ─── Rectify: max |x| across sidechain channels ───────────────────
+        if (numScChannels > 0)
+        {
+            juce::FloatVectorOperations::abs (g, sidechain[0] + startSample, numSamples);
+            for (int ch = 1; ch < numScChannels; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    g[i] = juce::jmax (g[i], std::abs (sidechain[ch][startSample + i]));
+        }
+        else
+        {
+            juce::FloatVectorOperations::fill (g, 0.0f, numSamples);
+        }
+
+        // ─── Peak envelope (the only inherently serial step) ──────────────
+        const float attCoeff = coeffFor (s.attackMs);
+        const float relCoeff = coeffFor (s.releaseMs);
+        float env = envelope;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float x = g[i];
+            const float c = x > env ? attCoeff : relCoeff;
+            env = x + c * (env - x);
+            g[i] = env;
+        }
+        envelope = env;
+
+        // ─── Gain computer: linear-domain soft ramp above threshold ───────
+        const float thr = juce::Decibels::decibelsToGain (s.thresholdDb);
+        juce::FloatVectorOperations::add      (g, -thr, numSamples);
+        juce::FloatVectorOperations::multiply (g, 1.0f / (thr * (KNEE - 1.0f)), numSamples);
+        juce::FloatVectorOperations::clip     (g, g, 0.0f, 1.0f, numSamples);
+
+        // ─── Depth: gain = 1 − depth · amount ─────────────────────────────
+        if (smoothDepth.isSmoothing())
+        {
+            for (int i = 0; i < numSamples; ++i)
+                g[i] = 1.0f - smoothDepth.getNextValue() * g[i];
+        }
+        else
+        {
+            juce::FloatVectorOperations::multiply (g, -smoothDepth.getTargetValue(), numSamples);
+            juce::FloatVectorOperations::add      (g, 1.0f, numSamples);
+        }
+
+        return g;
+    }
+
+private:
+    float coeffFor (float ms) const noexcept
+    {
+        return std::exp (-1.0f / (juce::jmax (0.01f, ms) * 0.001f * (float) currentSampleRate));
+    }
+
+    static constexpr float KNEE = 4.0f;   // full duck 12 dB over threshold
+
+    double currentSampleRate { 44100.0 };
+    float envelope { 0.0f };
+    std::vector<float> gains = std::vector<float> (512, 1.0f);   // resized in prepare
+    juce::LinearSmoothedValue<float> smoothDepth;
+};
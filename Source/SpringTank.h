@@ -0,0 +1,524 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "ParameterRanges.hpp"
+#include <array>
+#include <cmath>
+#include <vector>
+
+// =============================================================================
+// Schroeder delay-based allpass section
+//
+// Transfer function: H(z) = (g + z^-N) / (1 + g*z^-N)
+// State equation:    v[n] = x[n] - g*v[n-N]
+//                    y[n] = g*v[n] + v[n-N]
+//
+// Used in the spring tank to provide dense, diffuse reflections.
+// =============================================================================
+struct AllpassSection
+{
+    std::vector<float> buf;
+    int writePos { 0 };
+    int maxSize  { 0 };
+
+    void prepare (int maxDelaySamples)
+    {
+        maxSize = maxDelaySamples + 4;   // headroom for interpolation
+        buf.assign ((size_t) maxSize, 0.0f);
+        writePos = 0;
+    }
+
+    // Fixed integer delay allpass
+    float process (float input, int delaySamples, float g) noexcept
+    {
+        delaySamples = juce::jlimit (1, maxSize - 2, delaySamples);
+        const int readPos = (writePos - delaySamples + maxSize) % maxSize;
+        const float vDelayed = buf[(size_t) readPos];
+        const float v = input - g * vDelayed;
+        buf[(size_t) writePos] = v;
+        writePos = (writePos + 1) % maxSize;
+        return g * v + vDelayed;
+    }
+
+    // ─── Fractional-delay access (modulated AP3, see FractionalDelay) ────────
+    // Copies `count` consecutive taps, delays firstDelay, firstDelay+1, …
+    void readTaps (int firstDelay, int count, float* taps) const noexcept
+    {
+        int r = writePos - firstDelay;
+        if (r < 0) r += maxSize;
+
+        for (int k = 0; k < count; ++k)
+        {
+            taps[k] = buf[(size_t) r];
+            r = (r == 0 ? maxSize : r) - 1;
+        }
+    }
+
+    // Completes one allpass step from an already-interpolated v[n-D]
+    float commit (float input, float vDelayed, float g) noexcept
+    {
+        const float v = input - g * vDelayed;
+        buf[(size_t) writePos] = v;
+        if (++writePos == maxSize) writePos = 0;
+        lastDelayed = vDelayed;
+        return g * v + vDelayed;
+    }
+
+    float lastDelayed { 0.0f };   // previous interpolated read (allpass-interp state)
+
+    void reset() noexcept
+    {
+        std::fill (buf.begin(), buf.end(), 0.0f);
+        writePos = 0;
+        lastDelayed = 0.0f;
+    }
+};
+
+// =============================================================================
+// Fractional-delay kernels for the modulated AP3 stage
+//
+// Each kernel is a compile-time policy: a window of N taps around the integer
+// delay and a weight function of the fractional part.  processPair() runs
+// String A and String B through the same kernel together: both strings' taps,
+// fractions and weights sit in one contiguous 2×N lane array, so the weight
+// polynomials and tap products compile to straight-line SIMD (cubic kernels:
+// two 4-lane SSE/NEON vectors per step, one on AVX).
+//
+// Cost per call as reported by NFReverbKernelBench (Source/KernelBenchMain.cpp;
+// g++ 12 -O3, x86-64 baseline SSE2, best of 7 — re-run it when a kernel changes):
+//                                             processPair    whole tank sample
+//   Linear    2 taps                           ~12 ns  1.0×       ~68 ns
+//   Lagrange  4 taps, 3rd order                ~24 ns  2.0×       ~84 ns
+//   Hermite   4 taps, Catmull-Rom              ~24 ns  2.0×       ~84 ns
+//   Allpass   2 taps + 1 state, 1st order      ~14 ns  1.2×       ~69 ns
+// The rest of SpringTank::processSample (LFO sin, drive tanh, damping filters)
+// dominates, so a cubic kernel adds ~25 % to the tank and the allpass ~2 %.
+// =============================================================================
+namespace FractionalDelay
+{
+    enum class Kernel { linear = 0, lagrange, hermite, allpass };
+
+    // Display names, in Kernel order (the "interp" parameter's choices)
+    inline juce::StringArray getKernelNames() { return { "Linear", "Lagrange", "Hermite", "Allpass" }; }
+
+    // Taps at delays intD, intD+1:  (1−f)·x0 + f·x1
+    struct Linear
+    {
+        static constexpr int  numTaps   = 2;
+        static constexpr int  firstTap  = 0;
+        static constexpr bool recursive = false;
+
+        static void weights (const float* f, float* w) noexcept
+        {
+            for (int i = 0; i < 2 * numTaps; i += 2)
+            {
+                w[i]     = 1.0f - f[i];
+                w[i + 1] = f[i + 1];
+            }
+        }
+    };
+
+    // Cubic kernels: taps at delays intD−1 … intD+2, each weight a cubic in f,
+    // stored per power (c3·f³ + c2·f² + c1·f + c0) so every lane is one FMA chain
+    template <typename Coeffs>
+    struct Cubic
+    {
+        static constexpr int  numTaps   = 4;
+        static constexpr int  firstTap  = -1;
+        static constexpr bool recursive = false;
+
+        static void weights (const float* f, float* w) noexcept
+        {
+            for (int i = 0; i < 2 * numTaps; ++i)
+            {
+                const int k = i & 3;
+                w[i] = ((Coeffs::c3[k] * f[i] + Coeffs::c2[k]) * f[i] + Coeffs::c1[k]) * f[i]
+                     + Coeffs::c0[k];
+            }
+        }
+    };
+
+    // 4-point, 3rd-order Lagrange (flattest passband of the polynomial kernels)
+    struct LagrangeCoeffs
+    {
+        static constexpr float c3[4] { -1.0f / 6.0f,  0.5f, -0.5f, 1.0f / 6.0f };
+        static constexpr float c2[4] {  0.5f,        -1.0f,  0.5f, 0.0f };
+        static constexpr float c1[4] { -1.0f / 3.0f, -0.5f,  1.0f, -1.0f / 6.0f };
+        static constexpr float c0[4] {  0.0f,         1.0f,  0.0f, 0.0f };
+    };
+
+    // 4-point Hermite / Catmull-Rom (smoother under fast modulation)
+    struct HermiteCoeffs
+    {
+        static constexpr float c3[4] { -0.5f,  1.5f, -1.5f,  0.5f };
+        static constexpr float c2[4] {  1.0f, -2.5f,  2.0f, -0.5f };
+        static constexpr float c1[4] { -0.5f,  0.0f,  0.5f,  0.0f };
+        static constexpr float c0[4] {  0.0f,  1.0f,  0.0f,  0.0f };
+    };
+
+    using Lagrange = Cubic<LagrangeCoeffs>;
+    using Hermite  = Cubic<HermiteCoeffs>;
+
+    // First-order allpass (Thiran) over taps intD−1, intD with Δ = 1 + f, so
+    // η = (1 − Δ)/(1 + Δ) = −f/(2 + f) stays in (−⅓, 0] — always stable, and
+    // unity magnitude at every frequency (no high-frequency dulling):
+    //   y = η·x[intD−1] + x[intD] − η·y[n−1]
+    struct Allpass
+    {
+        static constexpr int  numTaps   = 2;
+        static constexpr int  firstTap  = -1;
+        static constexpr bool recursive = true;
+
+        static void weights (const float* f, float* w) noexcept
+        {
+            for (int i = 0; i < 2 * numTaps; i += 2)
+            {
+                w[i]     = -f[i] / (2.0f + f[i]);
+                w[i + 1] = 1.0f;
+            }
+        }
+    };
+
+    //==========================================================================
+    // Both strings' AP3 through kernel K.  Delays are clamped so every tap
+    // (intD−1 … intD+2) is a sample already written to the buffer.
+    template <typename K>
+    inline void processPair (AllpassSection& a, AllpassSection& b,
+                             float& xA, float& xB, float delayA, float delayB, float g) noexcept
+    {
+        constexpr int    N     = K::numTaps;
+        constexpr size_t lanes = (size_t) (2 * N);
+
+        delayA = juce::jlimit (2.0f, (float) (a.maxSize - 3), delayA);
+        delayB = juce::jlimit (2.0f, (float) (b.maxSize - 3), delayB);
+
+        const int intA = (int) delayA;
+        const int intB = (int) delayB;
+        const float fracA = delayA - (float) intA;
+        const float fracB = delayB - (float) intB;
+
+        // Lanes [0, N) = String A, [N, 2N) = String B
+        alignas (16) float taps[lanes];
+        alignas (16) float frac[lanes];
+        alignas (16) float w[lanes];
+
+        a.readTaps (intA + K::firstTap, N, taps);
+        b.readTaps (intB + K::firstTap, N, taps + N);
+
+        for (int i = 0; i < N; ++i)
+        {
+            frac[i]     = fracA;
+            frac[N + i] = fracB;
+        }
+
+        K::weights (frac, w);
+
+        for (int i = 0; i < 2 * N; ++i)
+            taps[i] *= w[i];
+
+        float yA = 0.0f, yB = 0.0f;
+        for (int i = 0; i < N; ++i)
+        {
+            yA += taps[i];
+            yB += taps[N + i];
+        }
+
+        if constexpr (K::recursive)
+        {
+            yA -= w[0] * a.lastDelayed;
+            yB -= w[N] * b.lastDelayed;
+        }
+
+        xA = a.commit (xA, yA, g);
+        xB = b.commit (xB, yB, g);
+    }
+}
+
+// =============================================================================
+// Simple mono circular pre-delay buffer
+// =============================================================================
+struct PreDelayBuffer
+{
+    std::vector<float> buf;
+    int writePos { 0 };
+    int maxSize  { 0 };
+
+    void prepare (int maxDelaySamples)
+    {
+        maxSize = maxDelaySamples + 2;
+        buf.assign ((size_t) maxSize, 0.0f);
+        writePos = 0;
+    }
+
+    void write (float sample) noexcept
+    {
+        buf[(size_t) writePos] = sample;
+        writePos = (writePos + 1) % maxSize;
+    }
+
+    float read (int delaySamples) const noexcept
+    {
+        delaySamples = juce::jlimit (0, maxSize - 1, delaySamples);
+        const int readPos = (writePos - 1 - delaySamples + maxSize) % maxSize;
+        return buf[(size_t) readPos];
+    }
+
+    void reset() noexcept
+    {
+        std::fill (buf.begin(), buf.end(), 0.0f);
+        writePos = 0;
+    }
+};
+
+// =============================================================================
+// Plain-value snapshot of every parameter that shapes the wet signal.
+//
+// The processor builds one per block from the APVTS; the decay analyser keeps
+// them as cache keys, so equality is exact (no tolerance).  Defaults are the
+// parameter defaults (ParameterRanges.hpp).
+// =============================================================================
+struct SpringTankSettings
+{
+    float decay      { ParameterRanges::decay.defaultValue };       // s
+    float tension    { ParameterRanges::tension.defaultValue };
+    float preDelayMs { ParameterRanges::pre_delay.defaultValue };   // ms
+    float damping    { ParameterRanges::damping.defaultValue };
+    float wobble     { ParameterRanges::wobble.defaultValue };
+    float drive      { ParameterRanges::drive.defaultValue };
+    FractionalDelay::Kernel interp { (FractionalDelay::Kernel) ParameterRanges::interpDefault };   // AP3 kernel
+
+    bool operator== (const SpringTankSettings& o) const noexcept
+    {
+        return decay == o.decay && tension == o.tension && preDelayMs == o.preDelayMs
+            && damping == o.damping && wobble == o.wobble && drive == o.drive
+            && interp == o.interp;
+    }
+
+    bool operator!= (const SpringTankSettings& o) const noexcept { return ! (*this == o); }
+};
+
+// =============================================================================
+// SpringTank — the wet signal path, independent of the plugin wrapper
+//
+//   Input → PreDelay → Drive (tanh) → String A / String B → Wet output
+//
+// Spring Tank (2 parallel strings, String A = left, String B = right):
+//   Input + Feedback → AP1 → AP2 → AP3[LFO, kernel] → Output
+//                                            → LP(damping) → × fbGain → Feedback
+//
+// Owned by the processor for real-time use, and instantiated separately as a
+// shadow copy by the decay analyser so both always share the same DSP.
+// =============================================================================
+class SpringTank
+{
+public:
+    //==========================================================================
+    void prepare (double sampleRate, int maximumBlockSize)
+    {
+        currentSampleRate = sampleRate;
+
+        // ─── Compute allpass delay lengths from sample rate ────────────────
+        // String A: 5 ms, 9 ms, 14 ms
+        apDelayA[0] = (int) (0.005 * sampleRate);
+        apDelayA[1] = (int) (0.009 * sampleRate);
+        apDelayA[2] = (int) (0.014 * sampleRate);
+
+        // String B: 7 ms, 11 ms, 16 ms  (+2 ms offset for decorrelation)
+        apDelayB[0] = (int) (0.007 * sampleRate);
+        apDelayB[1] = (int) (0.011 * sampleRate);
+        apDelayB[2] = (int) (0.016 * sampleRate);
+
+        // Max wobble = 3 ms
+        maxWobbleSamples = (float) (0.003 * sampleRate);
+
+        // ─── Pre-delay buffers (max 100 ms per channel) ───────────────────
+        const int maxPreDelaySamples = (int) (0.1 * sampleRate) + 1;
+        for (auto& pd : preDelay)
+            pd.prepare (maxPreDelaySamples);
+
+        // ─── Spring tank allpass sections ─────────────────────────────────
+        // AP1 and AP2: fixed delay, no modulation
+        // AP3: modulated, needs headroom for LFO (base + 3 ms)
+        for (int i = 0; i < 2; ++i)
+        {
+            apA[(size_t) i].prepare (apDelayA[i] + 4);
+            apB[(size_t) i].prepare (apDelayB[i] + 4);
+        }
+        apA[2].prepare ((int) (apDelayA[2] + maxWobbleSamples) + 4);
+        apB[2].prepare ((int) (apDelayB[2] + maxWobbleSamples) + 4);
+
+        // ─── Damping LP filters (mono, one per string) ────────────────────
+        juce::dsp::ProcessSpec monoSpec;
+        monoSpec.sampleRate       = sampleRate;
+        monoSpec.maximumBlockSize = (juce::uint32) maximumBlockSize;
+        monoSpec.numChannels      = 1;
+
+        for (auto* damp : { &dampA, &dampB })
+        {
+            damp->setType (juce::dsp::FirstOrderTPTFilterType::lowpass);
+            damp->setCutoffFrequency (8000.0f);
+            damp->prepare (monoSpec);
+            damp->reset();
+        }
+
+        reset();
+    }
+
+    // Clears every delay line, the feedback paths and the LFO phases
+    void reset() noexcept
+    {
+        for (auto& pd : preDelay) pd.reset();
+        for (auto& ap : apA)      ap.reset();
+        for (auto& ap : apB)      ap.reset();
+        dampA.reset();
+        dampB.reset();
+        feedbackA = 0.0f;
+        feedbackB = 0.0f;
+        lfoPhaseA = 0.0f;
+        lfoPhaseB = 0.0f;
+    }
+
+    //==========================================================================
+    // Derive block-level DSP values from a parameter snapshot.
+    // Cheap enough to call once per processBlock.
+    void setSettings (const SpringTankSettings& s) noexcept
+    {
+        const float decay_n = juce::jmax (0.01f, s.decay);
+
+        // Allpass coefficient: tension maps [0,1] → [0.30, 0.75]
+        apCoeff = juce::jlimit (0.2f, 0.8f, 0.30f + s.tension * 0.45f);
+
+        // Damping LP cutoff: damping 0 = 16 kHz (bright), 1 = 2 kHz (dark)
+        const float lpCutoff = 16000.0f - s.damping * 14000.0f;
+        dampA.setCutoffFrequency (lpCutoff);
+        dampB.setCutoffFrequency (lpCutoff);
+
+        // Feedback gain from RT60 formula:  fb = 10^(-3 * T_loop / T_60)
+        const float loopTimeA = (float)(apDelayA[0] + apDelayA[1] + apDelayA[2])
+                              / (float) currentSampleRate;
+        const float loopTimeB = (float)(apDelayB[0] + apDelayB[1] + apDelayB[2])
+                              / (float) currentSampleRate;
+        fbGainA = juce::jlimit (0.0f, 0.95f,
+            std::pow (10.0f, -3.0f * loopTimeA / decay_n));
+        fbGainB = juce::jlimit (0.0f, 0.95f,
+            std::pow (10.0f, -3.0f * loopTimeB / decay_n));
+
+        // Wobble LFO depth (samples) — up to 3 ms, AP3 fractional-delay kernel
+        wobDepth = s.wobble * maxWobbleSamples;
+        interp   = s.interp;
+
+        // Pre-delay in samples (clamped to buffer size)
+        preDelSamples = juce::jlimit (0, preDelay[0].maxSize - 2,
+            (int) (s.preDelayMs * (float) currentSampleRate * 0.001f));
+
+        // LFO phase increment per sample
+        lfoIncA = LFO_RATE_A / (float) currentSampleRate;
+        lfoIncB = LFO_RATE_B / (float) currentSampleRate;
+    }
+
+    // Drive parameter [0,1] → tanh gain factor [1, 4]
+    static float driveGainFor (float drive_n) noexcept { return 1.0f + drive_n * 3.0f; }
+
+    //==========================================================================
+    // One stereo sample through the wet path.  driveGain is passed in rather
+    // than taken from the settings so the caller can smooth it per sample.
+    void processSample (float inA, float inB, float driveGain,
+                        float& wetA, float& wetB) noexcept
+    {
+        const float twoPi = juce::MathConstants<float>::twoPi;
+
+        // ── AP1, AP2 — fixed delays, String A (left) then String B (right) ──
+        preDelay[0].write (inA);
+        float vA = applyDrive (preDelay[0].read (preDelSamples), driveGain);
+
+        vA += feedbackA;
+        vA = apA[0].process (vA, apDelayA[0], apCoeff);
+        vA = apA[1].process (vA, apDelayA[1], apCoeff);
+
+        preDelay[1].write (inB);
+        float vB = applyDrive (preDelay[1].read (preDelSamples), driveGain);
+
+        vB += feedbackB;
+        vB = apB[0].process (vB, apDelayB[0], apCoeff);
+        vB = apB[1].process (vB, apDelayB[1], apCoeff);
+
+        // ── AP3 with LFO modulation — both strings through one kernel ─────
+        const float modA = (float) apDelayA[2] + wobDepth * std::sin (twoPi * lfoPhaseA);
+        const float modB = (float) apDelayB[2] + wobDepth * std::sin (twoPi * lfoPhaseB);
+
+        using namespace FractionalDelay;
+
+        switch (interp)
+        {
+            case Kernel::lagrange: processPair<Lagrange> (apA[2], apB[2], vA, vB, modA, modB, apCoeff); break;
+            case Kernel::hermite:  processPair<Hermite>  (apA[2], apB[2], vA, vB, modA, modB, apCoeff); break;
+            case Kernel::allpass:  processPair<Allpass>  (apA[2], apB[2], vA, vB, modA, modB, apCoeff); break;
+            case Kernel::linear:
+            default:               processPair<Linear>   (apA[2], apB[2], vA, vB, modA, modB, apCoeff); break;
+        }
+
+        // Update feedback through damping LP
+        feedbackA = dampA.processSample (0, vA) * fbGainA;
+        feedbackB = dampB.processSample (0, vB) * fbGainB;
+
+        // ── Advance LFO phases ────────────────────────────────────────────
+        lfoPhaseA += lfoIncA;
+        if (lfoPhaseA >= 1.0f) lfoPhaseA -= 1.0f;
+        lfoPhaseB += lfoIncB;
+        if (lfoPhaseB >= 1.0f) lfoPhaseB -= 1.0f;
+
+        wetA = vA;
+        wetB = vB;
+    }
+
+    double getSampleRate() const noexcept { return currentSampleRate; }
+
+private:
+    //==========================================================================
+    // Drive (tanh soft saturation, unity-gain normalised for small signals)
+    // tanh(x * g) / g  →  approaches x as g → 1, clips softly as g increases
+    static float applyDrive (float x, float driveGain) noexcept
+    {
+        return std::tanh (x * driveGain) / driveGain;
+    }
+
+    double currentSampleRate { 44100.0 };
+
+    // ─── Pre-delay (one buffer per channel, max 100 ms) ───────────────────────
+    std::array<PreDelayBuffer, 2> preDelay;
+
+    // ─── Spring tank: String A (left) ─────────────────────────────────────────
+    std::array<AllpassSection, 3> apA;
+    juce::dsp::FirstOrderTPTFilter<float> dampA;   // LP filter in feedback path
+    float feedbackA { 0.0f };
+
+    // ─── Spring tank: String B (right, +2 ms offset for decorrelation) ────────
+    std::array<AllpassSection, 3> apB;
+    juce::dsp::FirstOrderTPTFilter<float> dampB;
+    float feedbackB { 0.0f };
+
+    // ─── LFO (one per string, rates slightly detuned) ─────────────────────────
+    float lfoPhaseA  { 0.0f };
+    float lfoPhaseB  { 0.0f };
+    float lfoIncA    { 0.0f };
+    float lfoIncB    { 0.0f };
+    static constexpr float LFO_RATE_A = 0.50f;   // Hz
+    static constexpr float LFO_RATE_B = 0.71f;   // Hz
+
+    // ─── Allpass delay lengths (samples, computed in prepare) ─────────────────
+    // String A: ~5 ms, ~9 ms, ~14 ms
+    // String B: ~7 ms, ~11 ms, ~16 ms  (+2 ms offset)
+    int apDelayA[3] { 220, 397, 617 };
+    int apDelayB[3] { 308, 485, 705 };
+
+    // Max LFO wobble depth in samples (= 3 ms at current sample rate)
+    float maxWobbleSamples { 132.0f };
+
+    // ─── Block-level values derived in setSettings ────────────────────────────
+    float apCoeff       { 0.525f };
+    float fbGainA       { 0.0f };
+    float fbGainB       { 0.0f };
+    float wobDepth      { 0.0f };
+    int   preDelSamples { 0 };
+    FractionalDelay::Kernel interp { FractionalDelay::Kernel::linear };
+};